@@ -9,10 +9,30 @@
 #include <memory> // For unique_ptr
 #include <iostream>
 #include <fstream>
+#include <sstream>   // For decoding levels from a campaign pack
 #include <cstdlib> // For rand(), srand()
 #include <ctime>   // For time()
 #include <algorithm> // For std::remove_if
 #include <stdexcept> // For std::exception in main
+#include <cstdint>   // For fixed-width observation/rng types
+#include <cstring>   // For memset in observation writes
+#include <chrono>    // For env benchmark timing
+#include <thread>    // For VecEnv worker threads
+#include <mutex>
+#include <condition_variable>
+#include <atomic>    // For the heap allocation counter
+#include <new>       // For replacing global operator new/delete
+#include <cstdarg>   // For FrameArena::format
+#include <cstdio>
+#include <climits>
+#include <cmath>     // For particle burst directions
+#ifdef __linux__
+#include <sys/inotify.h> // For LevelWatcher
+#include <unistd.h>
+#else
+#include <sys/types.h>   // For LevelWatcher's mtime polling fallback
+#include <sys/stat.h>
+#endif
 
 // ==========================================================================
 // 2. Using Namespaces
@@ -33,11 +53,53 @@ const char PATH_CHAR = ' ';
 const char PLAYER_CHAR = 'P';
 const char ITEM_CHAR = '*';
 const char ENEMY_CHAR = 'X';
+const char RANGED_ENEMY_CHAR = 'R';
 const float ENEMY_MOVE_INTERVAL = 1.0f;
 const float SHOOT_COOLDOWN = 0.3f;
 const float BULLET_TIME_PER_STEP = 0.05f;
+const float ENEMY_SHOOT_COOLDOWN = 1.5f;
+const float TARGET_FRAME_TIME = 1.0f / 60.0f;  // Frame pacing done in Game::run, after latency is sampled
 const string PLAYER_TEXTURE_PATH = "C:/Users/bibek/source/repos/MYTRY/x64/Debug/assets/player.png"; // !! ABSOLUTE PATH !!
 const string ENEMY_TEXTURE_PATH = "assets/enemy.png"; // Relative path
+const string CAMPAIGN_PACK_PATH = "campaign.pak";  // Falls back to levelN.txt files if missing
+const int LEGACY_LEVEL_COUNT = 2;                  // Number of levelN.txt files without a pack
+const int OBS_PLANES = 5;                        // Wall, item, enemy, bullet, player
+const float ENV_STEP_DT = BULLET_TIME_PER_STEP;  // One env step = one bullet cell
+const int ENV_MAX_STEPS = 2000;                  // Episode truncation for the headless env
+const size_t FRAME_ARENA_BYTES = 64 * 1024;      // Per-frame scratch memory
+const size_t BULLET_POOL_RESERVE = 64;           // Bullet slots reserved up front; spent bullets are recycled
+const size_t UI_TEXT_RESERVE = 32;              // Characters reserved in the score/level texts
+const size_t INPUT_QUEUE_CAPACITY = 64;          // Gameplay key presses buffered per tick
+const size_t LATENCY_SAMPLE_COUNT = 512;         // Rolling window for input latency percentiles
+const size_t PARTICLE_CAPACITY = 100000;         // Fixed particle pool size
+const float PARTICLE_SIZE = 3.f;
+const float PARTICLE_DRAG = 2.5f;                // Fraction of velocity lost per second
+
+// ==========================================================================
+// 3b. Allocation Accounting
+// ==========================================================================
+// Every global operator new bumps this; the stats overlay and --alloc-check
+// read it to report heap allocations per frame / per step.
+extern atomic<unsigned long long> heapAllocationCount;
+
+// Bump allocator for data that only lives until the end of the current frame.
+// reset() rewinds it; nothing is freed individually and nothing touches the heap
+// after construction.
+class FrameArena {
+public:
+    explicit FrameArena(size_t capacity);
+    void* allocate(size_t bytes, size_t alignment = alignof(max_align_t));
+    const char* format(const char* fmt, ...); // printf into arena memory, "" on overflow
+    void reset();
+    size_t getUsed() const;
+    size_t getPeak() const;
+    size_t getCapacity() const;
+private:
+    unique_ptr<unsigned char[]> buffer;
+    size_t capacity;
+    size_t used;
+    size_t peak;
+};
 
 // ==========================================================================
 // 4. Forward Declarations
@@ -48,6 +110,9 @@ class Entity;
 class Player;
 class Enemy;
 class Bullet;
+class VecEnv;
+class LevelWatcher;
+class CampaignPack;
 enum class GameState; // Defined later
 
 // ==========================================================================
@@ -75,6 +140,7 @@ class Level {
 public:
     Level();
     bool loadFromFile(const string& filename);
+    bool loadFromMemory(const string& data, const string& sourceName);
     bool saveToFile(const string& filename) const;
     void draw(RenderWindow& window, float cellSize);
     char getCell(int x, int y) const;
@@ -87,25 +153,114 @@ public:
     bool isItem(int x, int y) const;
     bool isEnemySpawn(int x, int y) const;
     bool isValid(int x, int y) const;
+    bool diffCells(const Level& other, vector<Vector2i>& changed) const; // False if sizes differ
+    bool hasLineOfSight(int x1, int y1, int x2, int y2) const; // Same row/column, no wall strictly between
 private:
+    bool loadFromStream(istream& input, const string& sourceName);
+    void rebuildWallMasks();
+    void setWallBit(int x, int y, bool wall);
+    void rebuildTiles(float cellSize);
+    void updateTile(int x, int y);
     vector<string> grid;
     size_t width;
     size_t height;
-    RectangleShape cellShape;
+    // Wall bitboards: bit x of row y lives in rowWalls[y * rowWords + x / 64],
+    // bit y of column x in colWalls[x * colWords + y / 64]. Kept in sync by setCell.
+    vector<uint64_t> rowWalls;
+    vector<uint64_t> colWalls;
+    size_t rowWords;
+    size_t colWords;
+    VertexArray tiles;             // Cached cell quads, built on first draw
+    vector<Vector2i> dirtyTiles;   // Cells changed by setCell since the last draw
+    bool tilesValid;
+    float tileCellSize;
     CircleShape itemShape;
 };
 
+// ==========================================================================
+// 6b. LevelWatcher Class Definition
+// ==========================================================================
+// Non-blocking change detection for the current level file. Uses inotify on
+// the file's directory on Linux (survives editors that save via rename) and
+// falls back to polling the modification time elsewhere.
+class LevelWatcher {
+public:
+    LevelWatcher();
+    ~LevelWatcher();
+    void watch(const string& filename);
+    bool poll(); // True once per batch of changes to the watched file
+private:
+    string path;
+#ifdef __linux__
+    string fileName;
+    int inotifyFd;
+    int watchFd;
+#else
+    time_t lastWriteTime;
+#endif
+};
+
+// ==========================================================================
+// 6c. CampaignPack Class Definition
+// ==========================================================================
+// Per-level tuning carried in the pack index. Defaults match the globals.
+struct LevelInfo {
+    string name;
+    float enemyMoveInterval = ENEMY_MOVE_INTERVAL;
+    float shootCooldown = SHOOT_COOLDOWN;
+    float enemyShootCooldown = ENEMY_SHOOT_COOLDOWN;
+};
+
+// Single-file campaign: a text header and index followed by the raw level
+// grids back to back.
+//
+//   VVTPACK 1
+//   levels <count>
+//   <name> <offset> <length> <enemyMoveInterval> <shootCooldown> <enemyShootCooldown>   (x count)
+//   data
+//   <level bytes...>
+//
+// Offsets are relative to the first byte after the "data" line. open() only
+// reads the index; decodeLevel() seeks to one level and parses just that one,
+// reusing the already-open stream.
+class CampaignPack {
+public:
+    CampaignPack();
+    bool open(const string& filename);
+    bool isOpen() const;
+    const string& getPath() const;
+    int getLevelCount() const;
+    const LevelInfo& getLevelInfo(int levelNumber) const; // 1-based
+    string getSourcePath(int levelNumber) const; // Level file the entry was built from, next to the pack
+    bool decodeLevel(int levelNumber, Level& out);
+    static bool build(const string& filename, const vector<string>& levelFiles);
+private:
+    struct Entry {
+        LevelInfo info;
+        unsigned long long offset;
+        size_t length;
+    };
+    string path;
+    ifstream file;
+    streamoff dataStart;
+    vector<Entry> index;
+    string decodeBuffer; // Reused between decodes
+};
+
 // ==========================================================================
 // 7. Bullet Class Definition
 // ==========================================================================
 class Bullet : public Entity {
 public:
-    Bullet(int startX, int startY, int dirX, int dirY);
+    Bullet(int startX, int startY, int dirX, int dirY, bool isHostile = false);
+    void reset(int startX, int startY, int dirX, int dirY, bool isHostile); // Reuse a pooled bullet
     void update(float dt, const Level& level, vector<Entity*>& others, Game& game) override;
     void draw(RenderWindow& window, float cellSize) const override;
     Vector2i getVelocity() const;
+    bool isHostile() const; // Fired by an enemy: hurts the player, passes through enemies
 private:
     Vector2i velocity;
+    bool hostile;
     RectangleShape shape;
     float moveTimer;
     const float timePerStep = BULLET_TIME_PER_STEP;
@@ -117,7 +272,7 @@ private:
 class Player : public Entity {
 public:
     Player(int startX, int startY, const Texture& texture);
-    void handleInput(Keyboard::Key key, Level& level, vector<unique_ptr<Bullet>>& bullets, Game& game);
+    bool handleInput(Keyboard::Key key, Level& level, Game& game); // True if the key changed what is on screen
     void update(float dt, const Level& level, vector<Entity*>& others, Game& game) override;
     void draw(RenderWindow& window, float cellSize) const override;
     void addScore(int points);
@@ -130,7 +285,7 @@ private:
     Vector2i facingDirection;
     Clock shootTimer;
     void tryMove(int dx, int dy, Level& level, Game& game); // Uses Game& game
-    void shoot(vector<unique_ptr<Bullet>>& bullets, const Level& level);
+    bool shoot(const Level& level, Game& game); // True if a bullet was fired
     void updateSpritePosition(float cellSize);
 };
 
@@ -139,13 +294,18 @@ private:
 // ==========================================================================
 class Enemy : public Entity {
 public:
-    Enemy(int startX, int startY, const Texture& texture);
+    Enemy(int startX, int startY, const Texture& texture, bool isRanged = false);
     void update(float dt, const Level& level, vector<Entity*>& others, Game& game) override;
     void draw(RenderWindow& window, float cellSize) const override;
+    Vector2i getSpawnCell() const; // Level cell whose marker created this enemy
 private:
     Sprite sprite;
     Clock moveTimer;
+    bool ranged;
+    Vector2i spawnCell;
+    Clock shootTimer;
     bool tryMoveRandom(const Level& level);
+    void tryShoot(const Level& level, Game& game);
     void updateSpritePosition(float cellSize);
 };
 
@@ -154,15 +314,73 @@ private:
 // ==========================================================================
 enum class GameState { Playing, Paused, GameOver, Victory, LevelComplete };
 
+// ==========================================================================
+// 10b. Input Queue / Latency Definitions
+// ==========================================================================
+typedef chrono::steady_clock InputClock;
+
+struct TimedInput {
+    Keyboard::Key key;
+    InputClock::time_point timestamp; // Taken when the event was polled
+};
+
+// Rolling window of input-to-display latencies (milliseconds). Fixed storage,
+// so recording and querying never allocate.
+class LatencyTracker {
+public:
+    LatencyTracker();
+    void record(float milliseconds);
+    float percentile(float p) const; // p in [0,1]; 0 if no samples yet
+    size_t getSampleCount() const;
+private:
+    float samples[LATENCY_SAMPLE_COUNT];
+    mutable float scratch[LATENCY_SAMPLE_COUNT];
+    size_t count;
+    size_t next;
+};
+
+// ==========================================================================
+// 10c. Particle System Definition
+// ==========================================================================
+// Fixed-size pool with structure-of-arrays state. Live particles are kept
+// packed in [0, liveCount) so the update loop is branch-free and the whole
+// pool is drawn with a single vertex-array call.
+class ParticleSystem {
+public:
+    explicit ParticleSystem(size_t capacity);
+    void emitBurst(Vector2f center, Color color, int count, float speed, float lifetime);
+    void update(float dt);
+    void draw(RenderWindow& window) const;
+    void clear();
+    size_t getLiveCount() const;
+    size_t getCapacity() const;
+    float getLastUpdateMicroseconds() const;
+private:
+    uint32_t nextRandom();
+    vector<float> posX, posY, velX, velY, life, invLifetime;
+    vector<Color> colors;
+    vector<Vertex> vertices; // 4 per particle (Quads), rebuilt by update()
+    size_t capacity;
+    size_t liveCount;
+    float lastUpdateMicroseconds;
+    uint32_t rngState;
+};
+
 // ==========================================================================
 // 11. Game Class Definition
 // ==========================================================================
 class Game {
 public:
-    Game();
+    explicit Game(bool headless = false); // Headless: no window, textures or font (used by --alloc-check)
     ~Game() = default;
     void run();
-    void setGameOver(const string& message); // Method used by Player
+    void setGameOver(const char* message); // Method used by Player
+    bool getPlayerPosition(Vector2i& out) const; // False if there is no live player
+    void spawnBullet(Vector2i start, Vector2i direction, bool hostile); // Takes a bullet from the pool
+    void spawnEnemyBullet(Vector2i from, Vector2i direction); // Used by ranged enemies
+    void spawnEffect(Vector2i cell, Color color, int count); // Particle burst centred on a cell
+    const LevelInfo& getLevelInfo() const; // Tuning for the level being played
+    unsigned long long measureSteadyStateAllocations(float warmupSeconds, float measureSeconds, size_t& steadyTicks, size_t& scoreChanges);
 private:
     void processEvents();
     void update(float dt);
@@ -173,18 +391,32 @@ private:
     void resetGame();
     void setupUI();
     void updateUI();
+    void setUiText(Text& text, const char* value);
+    void updateStatsOverlay();
+    void queueInput(Keyboard::Key key);
+    void consumeInputs();
+    void recordDisplayLatency();
     void checkCollisions();
     void cleanupEntities();
+    void recycleBullets(bool all);
     bool loadTextures();
+    void checkLevelReload();
+    bool readLevel(int levelNumber, Level& out);
 
     RenderWindow window;
     Texture playerTexture;
     Texture enemyTexture;
     Font font;
     Level currentLevelData;
+    Level levelFileSnapshot; // Level file as last read from disk, for hot-reload diffs
+    CampaignPack campaign;
+    LevelInfo currentLevelInfo;
+    string currentLevelFile;
+    LevelWatcher levelWatcher;
     unique_ptr<Player> player_ptr;
     vector<Enemy> enemies;
     vector<unique_ptr<Bullet>> bullets;
+    vector<unique_ptr<Bullet>> bulletPool; // Spent bullets waiting to be reused by spawnBullet
     GameState currentState;
     int currentLevelIndex;
     int totalLevels;
@@ -192,6 +424,106 @@ private:
     Text scoreText;
     Text levelText;
     Text messageText;
+    Text statsText;
+    RectangleShape overlayShape;
+    vector<Entity*> updateOthers; // Passed to Entity::update; reused so ticks don't allocate
+    FrameArena frameArena;
+    String uiString;              // Scratch for setUiText; keeps its capacity between refreshes
+    int shownScore;               // Values currently in scoreText/levelText
+    int shownLevel;
+    bool showStats;
+    unsigned long long lastFrameAllocations;
+    unsigned long long statsAllocations; // Allocations made by the overlay itself, excluded from the count
+    TimedInput inputQueue[INPUT_QUEUE_CAPACITY];      // Filled by processEvents, drained at tick start
+    size_t inputQueueCount;
+    InputClock::time_point awaitingDisplay[INPUT_QUEUE_CAPACITY]; // Applied inputs not yet presented
+    size_t awaitingDisplayCount;
+    LatencyTracker inputLatency;
+    ParticleSystem particles;
+};
+
+// ==========================================================================
+// 12. Vectorized Environment Definition (headless, for RL / batch sims)
+// ==========================================================================
+// Actions map 1:1 onto the keys Player::handleInput accepts.
+enum class EnvAction { None, Up, Down, Left, Right, Shoot, Count };
+Keyboard::Key envActionToKey(int action);
+
+// One headless game instance. Mirrors Game's rules (move/shoot/collide) on a
+// fixed ENV_STEP_DT tick with no window, textures or wall-clock timers.
+class EnvInstance {
+public:
+    EnvInstance();
+    void reset(const Level& templateLevel, const LevelInfo& levelInfo, uint32_t seed); // levelInfo must outlive the episode
+    void step(Keyboard::Key key, float& reward, bool& done);
+    void writeObservation(uint8_t* out) const; // OBS_PLANES * height * width bytes
+    uint32_t drawSeed() { return nextRandom(); } // Seed for the next auto-reset
+    bool isAlive() const { return alive; }
+private:
+    struct EnvBullet { Vector2i pos; Vector2i vel; bool active; bool hostile; };
+    struct EnvEnemy { Vector2i pos; bool ranged; float shootTimer; };
+    void applyKey(Keyboard::Key key);
+    void moveEnemies();
+    void enemiesShoot();
+    void moveBullets();
+    void checkCollisions();
+    uint32_t nextRandom();
+
+    Level level;
+    const LevelInfo* tuning; // Same per-level timings the game reads via Game::getLevelInfo
+    Vector2i player;
+    Vector2i facing;
+    bool alive;
+    int score;
+    int steps;
+    float shootTimer;
+    float enemyTimer;
+    float bulletTimer;
+    vector<EnvEnemy> enemies;
+    vector<EnvBullet> bullets;
+    uint32_t rngState;
+};
+
+// Batch of EnvInstances stepped across a persistent worker pool. All output
+// goes straight into caller-owned buffers laid out env-major:
+//   observations[numEnvs][OBS_PLANES][height][width], rewards[numEnvs], dones[numEnvs]
+// Finished envs auto-reset inside step(); their done flag reports the old episode.
+class VecEnv {
+public:
+    // levelSource is a level file, or "<pack>#<n>" for level n of a campaign pack (with its tuning).
+    VecEnv(size_t numEnvs, const string& levelSource, unsigned int numThreads = 0);
+    ~VecEnv();
+    bool isReady() const;
+    size_t getNumEnvs() const;
+    size_t getObservationSize() const; // Bytes per env
+    void reset(uint32_t seed, uint8_t* observations);
+    void step(const int* actions, uint8_t* observations, float* rewards, uint8_t* dones);
+private:
+    enum class Job { None, Reset, Step, Quit };
+    void dispatch(Job job);
+    void workerLoop(unsigned int workerIndex);
+    void runRange(unsigned int workerIndex);
+    bool loadTemplate(const string& levelSource);
+
+    Level templateLevel;
+    LevelInfo templateInfo;
+    vector<EnvInstance> envs;
+    vector<thread> workers;
+    unsigned int numThreads;
+    bool ready;
+    // Per-dispatch arguments, read by workers
+    uint32_t jobSeed;
+    const int* jobActions;
+    uint8_t* jobObservations;
+    float* jobRewards;
+    uint8_t* jobDones;
+    // Pool synchronisation
+    mutex poolMutex;
+    condition_variable jobReady;
+    condition_variable jobDone;
+    Job currentJob;
+    unsigned long long jobGeneration;
+    unsigned int workersFinished;
 };
 
 // ==========================================================================
@@ -201,6 +533,78 @@ private:
 // ==========================================================================
 
 
+// ==========================================================================
+// Allocation Accounting Implementation
+// ==========================================================================
+atomic<unsigned long long> heapAllocationCount(0);
+
+// All replacements go through this one acquire/release pair. They are kept
+// out of line so GCC does not inline free() into callers of operator delete
+// and report it as a mismatch with operator new (-Wmismatched-new-delete).
+#if defined(_MSC_VER)
+#define HEAP_NOINLINE __declspec(noinline)
+#elif defined(__GNUC__)
+#define HEAP_NOINLINE __attribute__((noinline))
+#else
+#define HEAP_NOINLINE
+#endif
+
+static HEAP_NOINLINE void* acquireHeapBlock(size_t size) {
+    heapAllocationCount.fetch_add(1, memory_order_relaxed);
+    return malloc(size ? size : 1);
+}
+
+static HEAP_NOINLINE void releaseHeapBlock(void* p) { free(p); }
+
+void* operator new(size_t size) {
+    if (void* p = acquireHeapBlock(size)) return p;
+    throw bad_alloc();
+}
+void* operator new[](size_t size) { return ::operator new(size); }
+void* operator new(size_t size, const nothrow_t&) noexcept { return acquireHeapBlock(size); }
+void* operator new[](size_t size, const nothrow_t&) noexcept { return acquireHeapBlock(size); }
+void operator delete(void* p) noexcept { releaseHeapBlock(p); }
+void operator delete[](void* p) noexcept { releaseHeapBlock(p); }
+void operator delete(void* p, size_t) noexcept { releaseHeapBlock(p); }
+void operator delete[](void* p, size_t) noexcept { releaseHeapBlock(p); }
+void operator delete(void* p, const nothrow_t&) noexcept { releaseHeapBlock(p); }
+void operator delete[](void* p, const nothrow_t&) noexcept { releaseHeapBlock(p); }
+
+FrameArena::FrameArena(size_t capacityBytes)
+    : buffer(new unsigned char[capacityBytes]), capacity(capacityBytes), used(0), peak(0) {}
+
+void* FrameArena::allocate(size_t bytes, size_t alignment) {
+    size_t start = (used + alignment - 1) & ~(alignment - 1);
+    if (start + bytes > capacity) {
+        cerr << "Warning: FrameArena exhausted (" << bytes << " bytes requested)" << endl;
+        return nullptr;
+    }
+    used = start + bytes;
+    peak = max(peak, used);
+    return buffer.get() + start;
+}
+
+const char* FrameArena::format(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    size_t available = capacity - used;
+    char* out = reinterpret_cast<char*>(buffer.get() + used);
+    int length = available > 0 ? vsnprintf(out, available, fmt, args) : -1;
+    va_end(args);
+    if (length < 0 || static_cast<size_t>(length) >= available) {
+        cerr << "Warning: FrameArena exhausted while formatting" << endl;
+        return "";
+    }
+    used += static_cast<size_t>(length) + 1;
+    peak = max(peak, used);
+    return out;
+}
+
+void FrameArena::reset() { used = 0; }
+size_t FrameArena::getUsed() const { return used; }
+size_t FrameArena::getPeak() const { return peak; }
+size_t FrameArena::getCapacity() const { return capacity; }
+
 // ==========================================================================
 // Entity Implementation
 // ==========================================================================
@@ -219,9 +623,7 @@ void Entity::destroy() { active = false; }
 // ==========================================================================
 // Level Implementation
 // ==========================================================================
-Level::Level() : width(0), height(0) {
-    cellShape.setOutlineThickness(1.f);
-    cellShape.setOutlineColor(Color(50, 50, 50));
+Level::Level() : width(0), height(0), rowWords(0), colWords(0), tiles(Quads), tilesValid(false), tileCellSize(0.f) {
     itemShape.setRadius(CELL_SIZE * 0.2f);
     itemShape.setFillColor(Color::Magenta);
     itemShape.setOrigin(itemShape.getRadius(), itemShape.getRadius());
@@ -232,28 +634,40 @@ bool Level::loadFromFile(const string& filename) {
     if (!inputFile) {
         cerr << "Error: Could not open level file: " << filename << endl; return false;
     }
+    return loadFromStream(inputFile, filename);
+}
+
+bool Level::loadFromMemory(const string& data, const string& sourceName) {
+    istringstream input(data);
+    return loadFromStream(input, sourceName);
+}
+
+bool Level::loadFromStream(istream& input, const string& filename) {
     grid.clear();
     string line;
     size_t tempWidth = 0;
     bool firstLine = true;
-    while (getline(inputFile, line)) {
+    while (getline(input, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back(); // CRLF data read in binary mode
         if (line.empty()) continue;
         if (firstLine) {
             tempWidth = line.length(); firstLine = false;
         }
         else if (line.length() != tempWidth) {
             cerr << "Error: Inconsistent line length in level file: " << filename << endl;
-            inputFile.close(); return false;
+            return false;
         }
         grid.push_back(line);
     }
-    inputFile.close();
     if (grid.empty()) {
         cerr << "Error: Level file is empty: " << filename << endl;
         height = 0; width = 0; return false;
     }
     height = grid.size();
     width = tempWidth;
+    rebuildWallMasks();
+    tilesValid = false;
+    dirtyTiles.clear();
     cout << "Loaded level '" << filename << "' (" << width << "x" << height << ")" << endl;
     return true;
 }
@@ -270,15 +684,13 @@ bool Level::saveToFile(const string& filename) const {
 }
 
 void Level::draw(RenderWindow& window, float cellSize) {
-    cellShape.setSize(Vector2f(cellSize, cellSize));
+    if (!tilesValid || tileCellSize != cellSize) { rebuildTiles(cellSize); }
+    for (const auto& cell : dirtyTiles) { updateTile(cell.x, cell.y); }
+    dirtyTiles.clear();
+    window.draw(tiles);
     for (size_t y = 0; y < height; ++y) {
         for (size_t x = 0; x < width; ++x) {
-            cellShape.setPosition(static_cast<float>(x) * cellSize, static_cast<float>(y) * cellSize);
-            char cellType = grid[y][x];
-            Color fillColor = (cellType == WALL_CHAR) ? Color(100, 100, 255) : Color(40, 40, 40);
-            cellShape.setFillColor(fillColor);
-            window.draw(cellShape);
-            if (cellType == ITEM_CHAR) {
+            if (grid[y][x] == ITEM_CHAR) {
                 itemShape.setPosition(static_cast<float>(x) * cellSize + cellSize / 2.f, static_cast<float>(y) * cellSize + cellSize / 2.f);
                 window.draw(itemShape);
             }
@@ -286,6 +698,34 @@ void Level::draw(RenderWindow& window, float cellSize) {
     }
 }
 
+// Each cell is two quads: a full-size outline quad and an inset fill quad.
+void Level::rebuildTiles(float cellSize) {
+    tileCellSize = cellSize;
+    tiles.resize(width * height * 8);
+    for (size_t y = 0; y < height; ++y) {
+        for (size_t x = 0; x < width; ++x) {
+            updateTile(static_cast<int>(x), static_cast<int>(y));
+        }
+    }
+    tilesValid = true;
+}
+
+void Level::updateTile(int x, int y) {
+    if (!isValid(x, y)) return;
+    const float left = static_cast<float>(x) * tileCellSize, top = static_cast<float>(y) * tileCellSize;
+    const float inset = 1.f;
+    Vertex* quad = &tiles[(static_cast<size_t>(y) * width + static_cast<size_t>(x)) * 8];
+    Color fillColor = (grid[y][x] == WALL_CHAR) ? Color(100, 100, 255) : Color(40, 40, 40);
+    quad[0] = Vertex(Vector2f(left, top), Color(50, 50, 50));
+    quad[1] = Vertex(Vector2f(left + tileCellSize, top), Color(50, 50, 50));
+    quad[2] = Vertex(Vector2f(left + tileCellSize, top + tileCellSize), Color(50, 50, 50));
+    quad[3] = Vertex(Vector2f(left, top + tileCellSize), Color(50, 50, 50));
+    quad[4] = Vertex(Vector2f(left + inset, top + inset), fillColor);
+    quad[5] = Vertex(Vector2f(left + tileCellSize - inset, top + inset), fillColor);
+    quad[6] = Vertex(Vector2f(left + tileCellSize - inset, top + tileCellSize - inset), fillColor);
+    quad[7] = Vertex(Vector2f(left + inset, top + tileCellSize - inset), fillColor);
+}
+
 char Level::getCell(int x, int y) const {
     if (!isValid(x, y)) { return WALL_CHAR; }
     return grid[static_cast<size_t>(y)][static_cast<size_t>(x)];
@@ -294,6 +734,8 @@ char Level::getCell(int x, int y) const {
 void Level::setCell(int x, int y, char type) {
     if (isValid(x, y)) {
         grid[static_cast<size_t>(y)][static_cast<size_t>(x)] = type;
+        setWallBit(x, y, type == WALL_CHAR);
+        if (tilesValid) { dirtyTiles.emplace_back(x, y); } // Refreshed on next draw
     }
     else {
         cerr << "Warning: Attempted to set cell outside level bounds (" << x << "," << y << ")" << endl;
@@ -312,6 +754,59 @@ Vector2i Level::findChar(char target) const {
     return Vector2i(-1, -1);
 }
 
+bool Level::diffCells(const Level& other, vector<Vector2i>& changed) const {
+    if (other.width != width || other.height != height) { return false; }
+    for (size_t y = 0; y < height; ++y) {
+        if (grid[y] == other.grid[y]) continue; // Fast path for untouched rows
+        for (size_t x = 0; x < width; ++x) {
+            if (grid[y][x] != other.grid[y][x]) { changed.emplace_back(static_cast<int>(x), static_cast<int>(y)); }
+        }
+    }
+    return true;
+}
+
+void Level::rebuildWallMasks() {
+    rowWords = (width + 63) / 64;
+    colWords = (height + 63) / 64;
+    rowWalls.assign(height * rowWords, 0);
+    colWalls.assign(width * colWords, 0);
+    for (size_t y = 0; y < height; ++y)
+        for (size_t x = 0; x < width; ++x)
+            if (grid[y][x] == WALL_CHAR) setWallBit(static_cast<int>(x), static_cast<int>(y), true);
+}
+
+void Level::setWallBit(int x, int y, bool wall) {
+    uint64_t& rowWord = rowWalls[static_cast<size_t>(y) * rowWords + static_cast<size_t>(x) / 64];
+    uint64_t& colWord = colWalls[static_cast<size_t>(x) * colWords + static_cast<size_t>(y) / 64];
+    const uint64_t rowBit = 1ull << (x % 64), colBit = 1ull << (y % 64);
+    if (wall) { rowWord |= rowBit; colWord |= colBit; }
+    else { rowWord &= ~rowBit; colWord &= ~colBit; }
+}
+
+// True if any bit in [from, to] is set in a packed bit row.
+static bool anyBitInRange(const uint64_t* words, size_t from, size_t to) {
+    const size_t firstWord = from / 64, lastWord = to / 64;
+    const uint64_t firstMask = ~0ull << (from % 64);
+    const uint64_t lastMask = ~0ull >> (63 - to % 64);
+    if (firstWord == lastWord) return (words[firstWord] & firstMask & lastMask) != 0;
+    if (words[firstWord] & firstMask) return true;
+    for (size_t w = firstWord + 1; w < lastWord; ++w) { if (words[w]) return true; }
+    return (words[lastWord] & lastMask) != 0;
+}
+
+bool Level::hasLineOfSight(int x1, int y1, int x2, int y2) const {
+    if (!isValid(x1, y1) || !isValid(x2, y2)) return false;
+    if (y1 == y2) {
+        const int lo = min(x1, x2) + 1, hi = max(x1, x2) - 1;
+        return lo > hi || !anyBitInRange(&rowWalls[static_cast<size_t>(y1) * rowWords], static_cast<size_t>(lo), static_cast<size_t>(hi));
+    }
+    if (x1 == x2) {
+        const int lo = min(y1, y2) + 1, hi = max(y1, y2) - 1;
+        return lo > hi || !anyBitInRange(&colWalls[static_cast<size_t>(x1) * colWords], static_cast<size_t>(lo), static_cast<size_t>(hi));
+    }
+    return false;
+}
+
 bool Level::isValid(int x, int y) const {
     return x >= 0 && static_cast<size_t>(x) < width && y >= 0 && static_cast<size_t>(y) < height;
 }
@@ -324,7 +819,7 @@ bool Level::isWall(int x, int y) const {
 bool Level::isPath(int x, int y) const {
     if (!isValid(x, y)) { return false; }
     char cell = grid[static_cast<size_t>(y)][static_cast<size_t>(x)];
-    return cell == PATH_CHAR || cell == ITEM_CHAR || cell == PLAYER_CHAR || cell == ENEMY_CHAR;
+    return cell == PATH_CHAR || cell == ITEM_CHAR || cell == PLAYER_CHAR || cell == ENEMY_CHAR || cell == RANGED_ENEMY_CHAR;
 }
 
 bool Level::isItem(int x, int y) const {
@@ -334,18 +829,198 @@ bool Level::isItem(int x, int y) const {
 
 bool Level::isEnemySpawn(int x, int y) const {
     if (!isValid(x, y)) { return false; }
-    return grid[static_cast<size_t>(y)][static_cast<size_t>(x)] == ENEMY_CHAR;
+    char cell = grid[static_cast<size_t>(y)][static_cast<size_t>(x)];
+    return cell == ENEMY_CHAR || cell == RANGED_ENEMY_CHAR;
+}
+
+
+// ==========================================================================
+// LevelWatcher Implementation
+// ==========================================================================
+#ifdef __linux__
+LevelWatcher::LevelWatcher() : inotifyFd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)), watchFd(-1) {
+    if (inotifyFd < 0) { cerr << "Warning: inotify unavailable, level hot-reload disabled." << endl; }
+}
+
+LevelWatcher::~LevelWatcher() {
+    if (inotifyFd >= 0) close(inotifyFd);
+}
+
+void LevelWatcher::watch(const string& filename) {
+    if (inotifyFd < 0 || filename == path) return;
+    if (watchFd >= 0) { inotify_rm_watch(inotifyFd, watchFd); watchFd = -1; }
+    path = filename;
+    size_t slash = filename.find_last_of('/');
+    string directory = (slash == string::npos) ? "." : filename.substr(0, slash);
+    fileName = (slash == string::npos) ? filename : filename.substr(slash + 1);
+    watchFd = inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (watchFd < 0) { cerr << "Warning: Could not watch '" << directory << "' for level changes." << endl; }
+}
+
+bool LevelWatcher::poll() {
+    if (inotifyFd < 0 || watchFd < 0) return false;
+    alignas(inotify_event) char buffer[4096];
+    bool changed = false;
+    ssize_t length;
+    while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+        for (char* p = buffer; p < buffer + length; ) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(p);
+            if (event->len > 0 && fileName == event->name) changed = true;
+            p += sizeof(inotify_event) + event->len;
+        }
+    }
+    return changed;
+}
+#else
+LevelWatcher::LevelWatcher() : lastWriteTime(0) {}
+LevelWatcher::~LevelWatcher() {}
+
+static time_t levelFileWriteTime(const string& filename) {
+#ifdef _WIN32
+    struct _stat info;
+    return _stat(filename.c_str(), &info) == 0 ? info.st_mtime : 0;
+#else
+    struct stat info;
+    return stat(filename.c_str(), &info) == 0 ? info.st_mtime : 0;
+#endif
+}
+
+void LevelWatcher::watch(const string& filename) {
+    if (filename == path) return;
+    path = filename;
+    lastWriteTime = levelFileWriteTime(path);
+}
+
+bool LevelWatcher::poll() {
+    if (path.empty()) return false;
+    time_t writeTime = levelFileWriteTime(path);
+    if (writeTime == 0 || writeTime == lastWriteTime) return false;
+    lastWriteTime = writeTime;
+    return true;
+}
+#endif
+
+// ==========================================================================
+// CampaignPack Implementation
+// ==========================================================================
+CampaignPack::CampaignPack() : dataStart(0) {}
+
+bool CampaignPack::open(const string& filename) {
+    if (file.is_open()) file.close();
+    file.clear();
+    index.clear();
+    path = filename;
+    file.open(filename, ios::binary);
+    if (!file) return false;
+    file.seekg(0, ios::end);
+    const streamoff fileSize = file.tellg();
+    file.seekg(0, ios::beg);
+    string magic, levelsTag, dataTag;
+    int version = 0, count = 0;
+    if (!(file >> magic >> version >> levelsTag >> count) || magic != "VVTPACK" || version != 1 || levelsTag != "levels" || count < 0) {
+        cerr << "Error: '" << filename << "' is not a campaign pack." << endl;
+        file.close(); return false;
+    }
+    if (static_cast<streamoff>(count) > fileSize) { // Every index line takes at least one byte
+        cerr << "Error: Level count " << count << " does not fit in campaign pack '" << filename << "'" << endl;
+        file.close(); return false;
+    }
+    index.resize(static_cast<size_t>(count));
+    for (auto& entry : index) {
+        LevelInfo& info = entry.info;
+        if (!(file >> info.name >> entry.offset >> entry.length >> info.enemyMoveInterval >> info.shootCooldown >> info.enemyShootCooldown)) {
+            cerr << "Error: Truncated index in campaign pack '" << filename << "'" << endl;
+            file.close(); index.clear(); return false;
+        }
+    }
+    if (!(file >> dataTag) || dataTag != "data" || file.get() != '\n') {
+        cerr << "Error: Missing data section in campaign pack '" << filename << "'" << endl;
+        file.close(); index.clear(); return false;
+    }
+    dataStart = file.tellg();
+    const unsigned long long dataSize = static_cast<unsigned long long>(fileSize - dataStart);
+    for (const auto& entry : index) {
+        if (entry.offset > dataSize || entry.length > dataSize - entry.offset) {
+            cerr << "Error: Level '" << entry.info.name << "' runs past the end of campaign pack '" << filename << "'" << endl;
+            file.close(); index.clear(); return false;
+        }
+    }
+    cout << "Opened campaign pack '" << filename << "' (" << index.size() << " levels)" << endl;
+    return true;
+}
+
+bool CampaignPack::isOpen() const { return file.is_open(); }
+const string& CampaignPack::getPath() const { return path; }
+int CampaignPack::getLevelCount() const { return static_cast<int>(index.size()); }
+
+const LevelInfo& CampaignPack::getLevelInfo(int levelNumber) const {
+    return index[static_cast<size_t>(levelNumber - 1)].info;
+}
+
+string CampaignPack::getSourcePath(int levelNumber) const {
+    size_t slash = path.find_last_of("/\\");
+    string directory = slash == string::npos ? "" : path.substr(0, slash + 1);
+    return directory + getLevelInfo(levelNumber).name;
+}
+
+bool CampaignPack::decodeLevel(int levelNumber, Level& out) {
+    if (!isOpen() || levelNumber < 1 || levelNumber > getLevelCount()) {
+        cerr << "Error: Level " << levelNumber << " is not in campaign pack '" << path << "'" << endl;
+        return false;
+    }
+    const Entry& entry = index[static_cast<size_t>(levelNumber - 1)];
+    decodeBuffer.resize(entry.length);
+    file.clear();
+    file.seekg(dataStart + static_cast<streamoff>(entry.offset));
+    if (entry.length > 0 && !file.read(&decodeBuffer[0], static_cast<streamsize>(entry.length))) {
+        cerr << "Error: Could not read level " << levelNumber << " from '" << path << "'" << endl;
+        return false;
+    }
+    return out.loadFromMemory(decodeBuffer, path + ":" + entry.info.name);
 }
 
+// Packs loose level files with default tuning; edit the index lines to tune a level.
+bool CampaignPack::build(const string& filename, const vector<string>& levelFiles) {
+    string data;
+    ostringstream header;
+    header << "VVTPACK 1\nlevels " << levelFiles.size() << "\n";
+    LevelInfo defaults;
+    for (const auto& levelFile : levelFiles) {
+        ifstream input(levelFile, ios::binary);
+        if (!input) { cerr << "Error: Could not open level file: " << levelFile << endl; return false; }
+        ostringstream contents;
+        contents << input.rdbuf();
+        string name = levelFile.substr(levelFile.find_last_of("/\\") + 1);
+        replace(name.begin(), name.end(), ' ', '_');
+        header << name << " " << data.size() << " " << contents.str().size() << " "
+               << defaults.enemyMoveInterval << " " << defaults.shootCooldown << " " << defaults.enemyShootCooldown << "\n";
+        data += contents.str();
+    }
+    header << "data\n";
+    ofstream output(filename, ios::binary);
+    if (!output) { cerr << "Error: Could not open file for saving pack: " << filename << endl; return false; }
+    output << header.str() << data;
+    cout << "Saved campaign pack '" << filename << "' (" << levelFiles.size() << " levels)" << endl;
+    return true;
+}
 
 // ==========================================================================
 // Bullet Implementation
 // ==========================================================================
-Bullet::Bullet(int startX, int startY, int dirX, int dirY)
-    : Entity(startX, startY), velocity(dirX, dirY), moveTimer(0.0f) {
+Bullet::Bullet(int startX, int startY, int dirX, int dirY, bool isHostile)
+    : Entity(startX, startY), velocity(dirX, dirY), hostile(isHostile), moveTimer(0.0f) {
     shape.setSize(Vector2f(CELL_SIZE * 0.2f, CELL_SIZE * 0.2f));
-    shape.setFillColor(Color::Yellow);
     shape.setOrigin(shape.getSize().x / 2.f, shape.getSize().y / 2.f);
+    reset(startX, startY, dirX, dirY, isHostile);
+}
+
+void Bullet::reset(int startX, int startY, int dirX, int dirY, bool isHostile) {
+    position = { startX, startY };
+    velocity = { dirX, dirY };
+    hostile = isHostile;
+    moveTimer = 0.0f;
+    active = true;
+    shape.setFillColor(hostile ? Color::Red : Color::Yellow);
     shape.setPosition(position.x * CELL_SIZE + CELL_SIZE / 2.f, position.y * CELL_SIZE + CELL_SIZE / 2.f);
 }
 void Bullet::update(float dt, const Level& level, vector<Entity*>& others, Game& game) {
@@ -376,6 +1051,7 @@ void Bullet::draw(RenderWindow& window, float cellSize) const {
 }
 
 Vector2i Bullet::getVelocity() const { return velocity; }
+bool Bullet::isHostile() const { return hostile; }
 
 // ==========================================================================
 // Player Implementation
@@ -392,8 +1068,8 @@ Player::Player(int startX, int startY, const Texture& texture)
     updateSpritePosition(CELL_SIZE);
 }
 
-void Player::handleInput(Keyboard::Key key, Level& level, vector<unique_ptr<Bullet>>& bullets, Game& game) {
-    if (!active) return;
+bool Player::handleInput(Keyboard::Key key, Level& level, Game& game) {
+    if (!active) return false;
     int dx = 0, dy = 0;
     switch (key) {
     case Keyboard::W: dy = -1; break;
@@ -401,17 +1077,17 @@ void Player::handleInput(Keyboard::Key key, Level& level, vector<unique_ptr<Bull
     case Keyboard::A: dx = -1; break;
     case Keyboard::D: dx = 1;  break;
     case Keyboard::Space:
-        if (shootTimer.getElapsedTime().asSeconds() >= SHOOT_COOLDOWN) {
-            shoot(bullets, level);
+        if (shootTimer.getElapsedTime().asSeconds() >= game.getLevelInfo().shootCooldown) {
+            bool fired = shoot(level, game);
             shootTimer.restart();
+            return fired;
         }
-        return;
-    default: return;
-    }
-    if (dx != 0 || dy != 0) {
-        facingDirection = { dx, dy };
-        tryMove(dx, dy, level, game); // Calls method below
+        return false; // Still cooling down
+    default: return false;
     }
+    facingDirection = { dx, dy };
+    tryMove(dx, dy, level, game); // Calls method below
+    return true;
 }
 
 // THIS METHOD MUST BE IMPLEMENTED *AFTER* THE Game CLASS DEFINITION
@@ -439,19 +1115,20 @@ void Player::tryMove(int dx, int dy, Level& level, Game& game) {
         addScore(10);
         level.setCell(nextX, nextY, PATH_CHAR);
         cout << "Collected item! Score: " << score << endl;
+        game.spawnEffect(position, Color::Magenta, 30);
     }
     updateSpritePosition(CELL_SIZE);
 }
 
-void Player::shoot(vector<unique_ptr<Bullet>>& bullets, const Level& level) {
+bool Player::shoot(const Level& level, Game& game) {
     int bulletStartX = position.x + facingDirection.x;
     int bulletStartY = position.y + facingDirection.y;
     if (level.isValid(bulletStartX, bulletStartY) && !level.isWall(bulletStartX, bulletStartY)) {
-        bullets.push_back(make_unique<Bullet>(bulletStartX, bulletStartY, facingDirection.x, facingDirection.y));
-    }
-    else {
-        cout << "Blocked shot." << endl;
+        game.spawnBullet(Vector2i(bulletStartX, bulletStartY), facingDirection, false);
+        return true;
     }
+    cout << "Blocked shot." << endl;
+    return false;
 }
 
 void Player::update(float dt, const Level& level, vector<Entity*>& others, Game& game) {
@@ -487,8 +1164,9 @@ void Player::updateSpritePosition(float cellSize) {
 // ==========================================================================
 // Enemy Implementation
 // ==========================================================================
-Enemy::Enemy(int startX, int startY, const Texture& texture) : Entity(startX, startY) {
+Enemy::Enemy(int startX, int startY, const Texture& texture, bool isRanged) : Entity(startX, startY), ranged(isRanged), spawnCell(startX, startY) {
     sprite.setTexture(texture);
+    if (ranged) sprite.setColor(Color(255, 120, 120)); // Tint shooters so they read differently
     sprite.setOrigin(sprite.getLocalBounds().width / 2.f, sprite.getLocalBounds().height / 2.f);
     float desiredWidth = CELL_SIZE * 0.8f;
     float scale = (sprite.getLocalBounds().width > 0) ? desiredWidth / sprite.getLocalBounds().width : 1.0f;
@@ -496,13 +1174,14 @@ Enemy::Enemy(int startX, int startY, const Texture& texture) : Entity(startX, st
     sprite.setScale(scale, scale);
     updateSpritePosition(CELL_SIZE);
     moveTimer.restart();
+    shootTimer.restart();
 }
 
-// NOTE: This update currently does NOT call any Game methods.
 void Enemy::update(float dt, const Level& level, vector<Entity*>& others, Game& game) {
     if (!active) return;
+    if (ranged) tryShoot(level, game);
     bool moved = false;
-    if (moveTimer.getElapsedTime().asSeconds() >= ENEMY_MOVE_INTERVAL) {
+    if (moveTimer.getElapsedTime().asSeconds() >= game.getLevelInfo().enemyMoveInterval) {
         moved = tryMoveRandom(level);
         moveTimer.restart();
     }
@@ -530,32 +1209,150 @@ bool Enemy::tryMoveRandom(const Level& level) {
     return false;
 }
 
+// Fires along a row/column when the bitboard line-of-sight check sees the player.
+void Enemy::tryShoot(const Level& level, Game& game) {
+    if (shootTimer.getElapsedTime().asSeconds() < game.getLevelInfo().enemyShootCooldown) return;
+    Vector2i target;
+    if (!game.getPlayerPosition(target) || target == position) return;
+    if (!level.hasLineOfSight(position.x, position.y, target.x, target.y)) return;
+    Vector2i direction((target.x > position.x) - (target.x < position.x), (target.y > position.y) - (target.y < position.y));
+    game.spawnEnemyBullet(position, direction);
+    shootTimer.restart();
+}
+
 void Enemy::draw(RenderWindow& window, float cellSize) const {
     if (!active) return;
     window.draw(sprite);
 }
 
+Vector2i Enemy::getSpawnCell() const { return spawnCell; }
+
 void Enemy::updateSpritePosition(float cellSize) {
     sprite.setPosition(position.x * cellSize + cellSize / 2.f, position.y * cellSize + cellSize / 2.f);
 }
 
+// ==========================================================================
+// Input Latency Implementation
+// ==========================================================================
+LatencyTracker::LatencyTracker() : count(0), next(0) {}
+
+void LatencyTracker::record(float milliseconds) {
+    samples[next] = milliseconds;
+    next = (next + 1) % LATENCY_SAMPLE_COUNT;
+    count = min(count + 1, LATENCY_SAMPLE_COUNT);
+}
+
+float LatencyTracker::percentile(float p) const {
+    if (count == 0) return 0.f;
+    copy(samples, samples + count, scratch);
+    size_t rank = min(count - 1, static_cast<size_t>(p * static_cast<float>(count - 1) + 0.5f));
+    nth_element(scratch, scratch + rank, scratch + count);
+    return scratch[rank];
+}
+
+size_t LatencyTracker::getSampleCount() const { return count; }
+
+// ==========================================================================
+// Particle System Implementation
+// ==========================================================================
+ParticleSystem::ParticleSystem(size_t poolCapacity)
+    : posX(poolCapacity), posY(poolCapacity), velX(poolCapacity), velY(poolCapacity),
+      life(poolCapacity), invLifetime(poolCapacity), colors(poolCapacity), vertices(poolCapacity * 4),
+      capacity(poolCapacity), liveCount(0), lastUpdateMicroseconds(0.f), rngState(0x2545F491u) {}
+
+uint32_t ParticleSystem::nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+void ParticleSystem::emitBurst(Vector2f center, Color color, int count, float speed, float lifetime) {
+    for (int n = 0; n < count && liveCount < capacity; ++n) { // Pool full: extra particles are dropped
+        const float angle = static_cast<float>(nextRandom() % 6283) / 1000.f;
+        const float magnitude = speed * (0.3f + 0.7f * static_cast<float>(nextRandom() % 1000) / 1000.f);
+        const float span = lifetime * (0.5f + 0.5f * static_cast<float>(nextRandom() % 1000) / 1000.f);
+        const size_t i = liveCount++;
+        posX[i] = center.x; posY[i] = center.y;
+        velX[i] = cos(angle) * magnitude; velY[i] = sin(angle) * magnitude;
+        life[i] = span; invLifetime[i] = 1.f / span;
+        colors[i] = color;
+    }
+}
+
+void ParticleSystem::update(float dt) {
+    auto start = chrono::steady_clock::now();
+    // Integrate: plain SoA arithmetic over the packed range, no branches
+    float* px = posX.data(); float* py = posY.data();
+    float* vx = velX.data(); float* vy = velY.data();
+    float* lf = life.data();
+    const float drag = max(0.f, 1.f - PARTICLE_DRAG * dt);
+    for (size_t i = 0; i < liveCount; ++i) {
+        px[i] += vx[i] * dt;
+        py[i] += vy[i] * dt;
+        vx[i] *= drag;
+        vy[i] *= drag;
+        lf[i] -= dt;
+    }
+    // Compact: swap the last live particle into each dead slot
+    for (size_t i = 0; i < liveCount; ) {
+        if (lf[i] > 0.f) { ++i; continue; }
+        const size_t last = --liveCount;
+        px[i] = px[last]; py[i] = py[last]; vx[i] = vx[last]; vy[i] = vy[last];
+        lf[i] = lf[last]; invLifetime[i] = invLifetime[last]; colors[i] = colors[last];
+    }
+    // Rebuild quads, fading alpha with remaining life
+    const float half = PARTICLE_SIZE / 2.f;
+    for (size_t i = 0; i < liveCount; ++i) {
+        Color c = colors[i];
+        c.a = static_cast<Uint8>(255.f * min(1.f, lf[i] * invLifetime[i]));
+        Vertex* quad = &vertices[i * 4];
+        quad[0].position = Vector2f(px[i] - half, py[i] - half);
+        quad[1].position = Vector2f(px[i] + half, py[i] - half);
+        quad[2].position = Vector2f(px[i] + half, py[i] + half);
+        quad[3].position = Vector2f(px[i] - half, py[i] + half);
+        quad[0].color = quad[1].color = quad[2].color = quad[3].color = c;
+    }
+    lastUpdateMicroseconds = chrono::duration<float, micro>(chrono::steady_clock::now() - start).count();
+}
+
+void ParticleSystem::draw(RenderWindow& window) const {
+    if (liveCount == 0) return;
+    window.draw(vertices.data(), liveCount * 4, Quads);
+}
+
+void ParticleSystem::clear() { liveCount = 0; }
+size_t ParticleSystem::getLiveCount() const { return liveCount; }
+size_t ParticleSystem::getCapacity() const { return capacity; }
+float ParticleSystem::getLastUpdateMicroseconds() const { return lastUpdateMicroseconds; }
+
 // ==========================================================================
 // Game Implementation
 // ==========================================================================
-Game::Game() :
-    window(VideoMode(static_cast<unsigned int>(WINDOW_WIDTH), static_cast<unsigned int>(WINDOW_HEIGHT)), "Virat v thanos"),
-    currentState(GameState::Playing), currentLevelIndex(1), totalLevels(2), timeScale(1.0f) {
-    window.setFramerateLimit(60);
+Game::Game(bool headless) :
+    currentState(GameState::Playing), currentLevelIndex(1), totalLevels(LEGACY_LEVEL_COUNT), timeScale(1.0f),
+    frameArena(FRAME_ARENA_BYTES), shownScore(INT_MIN), shownLevel(INT_MIN), showStats(false),
+    lastFrameAllocations(0), statsAllocations(0), inputQueueCount(0), awaitingDisplayCount(0),
+    particles(PARTICLE_CAPACITY) {
     srand(static_cast<unsigned int>(time(NULL)));
     cout << "Game Constructor: Initializing..." << endl;
-    if (!loadTextures()) {
+    bullets.reserve(BULLET_POOL_RESERVE);
+    bulletPool.reserve(BULLET_POOL_RESERVE);
+    for (size_t i = 0; i < BULLET_POOL_RESERVE; ++i) { bulletPool.push_back(make_unique<Bullet>(0, 0, 0, 0)); } // First shots reuse these too
+    if (!headless) {
+        window.create(VideoMode(static_cast<unsigned int>(WINDOW_WIDTH), static_cast<unsigned int>(WINDOW_HEIGHT)), "Virat v thanos");
+    }
+    if (!headless && !loadTextures()) {
         cerr << "FATAL ERROR: Texture loading failed. Check paths/files.\n";
         currentState = GameState::GameOver; window.close();
         messageText.setString("FATAL ERROR:\nTextures missing."); // Basic msg
         return;
     }
     player_ptr = make_unique<Player>(0, 0, playerTexture);
-    if (!font.loadFromFile("arial.ttf")) {
+    if (headless) {
+        // Simulation only: sprites and texts stay untextured
+    }
+    else if (!font.loadFromFile("arial.ttf")) {
         cerr << "Error: Font 'arial.ttf' not found.\n";
         // Continue without text? Or make fatal? For now, continue.
     }
@@ -563,6 +1360,8 @@ Game::Game() :
         cout << "Font loaded." << endl;
     }
     setupUI();
+    if (campaign.open(CAMPAIGN_PACK_PATH)) { totalLevels = campaign.getLevelCount(); }
+    else { cout << "No campaign pack, using level1.." << totalLevels << ".txt" << endl; }
     loadLevel(currentLevelIndex); // Includes setupLevel()
     cout << "Game Constructor: Done." << endl;
 }
@@ -587,11 +1386,28 @@ void Game::run() {
     }
     cout << "Starting Game Loop..." << endl;
     Clock clock;
+    Clock frameTimer;
     while (window.isOpen()) {
-        float dt = clock.restart().asSeconds() * timeScale;
+        frameTimer.restart();
+        unsigned long long frameStartAllocations = heapAllocationCount.load(memory_order_relaxed);
+        statsAllocations = 0;
+        float frameDt = clock.restart().asSeconds();
+        float dt = frameDt * timeScale;
         processEvents();
+        checkLevelReload();
         if (currentState == GameState::Playing) { update(dt); }
+        if (currentState != GameState::Paused) { particles.update(frameDt); } // Death bursts keep playing on the game-over screen
         render();
+        frameArena.reset();
+        lastFrameAllocations = heapAllocationCount.load(memory_order_relaxed) - frameStartAllocations - statsAllocations;
+        // Pace here instead of setFramerateLimit: SFML's limiter sleeps inside display(),
+        // which would land in every input latency sample taken after it returns.
+        float spare = TARGET_FRAME_TIME - frameTimer.getElapsedTime().asSeconds();
+        if (spare > 0.f) { sleep(seconds(spare)); }
+    }
+    if (inputLatency.getSampleCount() > 0) {
+        cout << "Input latency over last " << inputLatency.getSampleCount() << " inputs: p50 "
+             << inputLatency.percentile(0.5f) << " ms, p99 " << inputLatency.percentile(0.99f) << " ms" << endl;
     }
     cout << "Exited Game Loop." << endl;
 }
@@ -601,25 +1417,58 @@ void Game::processEvents() {
     while (window.pollEvent(event)) {
         if (event.type == Event::Closed) { window.close(); }
         if (event.type == Event::KeyPressed) {
-            if (event.key.code == Keyboard::P) {
-                if (currentState == GameState::Playing) { currentState = GameState::Paused; timeScale = 0.0f; messageText.setString("PAUSED\nPress P"); }
+            if (event.key.code == Keyboard::F3) { showStats = !showStats; }
+            else if (event.key.code == Keyboard::P) {
+                if (currentState == GameState::Playing) { currentState = GameState::Paused; timeScale = 0.0f; inputQueueCount = 0; messageText.setString("PAUSED\nPress P"); }
                 else if (currentState == GameState::Paused) { currentState = GameState::Playing; timeScale = 1.0f; messageText.setString(""); }
             }
             else if ((currentState == GameState::GameOver || currentState == GameState::Victory) && event.key.code == Keyboard::R) { resetGame(); }
             else if (currentState == GameState::Playing && player_ptr && player_ptr->isActive()) {
-                player_ptr->handleInput(event.key.code, currentLevelData, bullets, *this);
+                queueInput(event.key.code); // Applied at the start of the next tick
             }
         }
     }
 }
 
+void Game::queueInput(Keyboard::Key key) {
+    if (inputQueueCount == INPUT_QUEUE_CAPACITY) {
+        cerr << "Warning: Input queue full, dropping key " << static_cast<int>(key) << endl;
+        return;
+    }
+    inputQueue[inputQueueCount++] = { key, InputClock::now() };
+}
+
+// Drains the queue in arrival order. Inputs that changed something (a move or a
+// fired shot, not a press swallowed by the cooldown) are remembered until the
+// next window.display() so their latency covers the whole tick + render.
+void Game::consumeInputs() {
+    for (size_t i = 0; i < inputQueueCount; ++i) {
+        if (currentState != GameState::Playing || !player_ptr || !player_ptr->isActive()) break;
+        bool applied = player_ptr->handleInput(inputQueue[i].key, currentLevelData, *this);
+        if (applied && awaitingDisplayCount < INPUT_QUEUE_CAPACITY) { awaitingDisplay[awaitingDisplayCount++] = inputQueue[i].timestamp; }
+    }
+    inputQueueCount = 0;
+}
+
+// Called right after display() returns. Run() paces frames itself, so no
+// frame-limiter sleep is included in the sample.
+void Game::recordDisplayLatency() {
+    InputClock::time_point shown = InputClock::now();
+    for (size_t i = 0; i < awaitingDisplayCount; ++i) {
+        inputLatency.record(chrono::duration<float, milli>(shown - awaitingDisplay[i]).count());
+    }
+    awaitingDisplayCount = 0;
+}
+
 void Game::update(float dt) {
     if (currentState != GameState::Playing || !player_ptr || !player_ptr->isActive()) return;
-    vector<Entity*> others_placeholder;
-    player_ptr->update(dt, currentLevelData, others_placeholder, *this);
+    consumeInputs();
+    if (currentState != GameState::Playing) return; // An input may have ended the game
+    updateOthers.clear();
+    player_ptr->update(dt, currentLevelData, updateOthers, *this);
     if (currentState != GameState::Playing) return; // State might change in player update
-    for (auto& enemy : enemies) { if (enemy.isActive()) enemy.update(dt, currentLevelData, others_placeholder, *this); }
-    for (auto& bullet_ptr : bullets) { if (bullet_ptr->isActive()) bullet_ptr->update(dt, currentLevelData, others_placeholder, *this); }
+    for (auto& enemy : enemies) { if (enemy.isActive()) enemy.update(dt, currentLevelData, updateOthers, *this); }
+    for (auto& bullet_ptr : bullets) { if (bullet_ptr->isActive()) bullet_ptr->update(dt, currentLevelData, updateOthers, *this); }
     checkCollisions();
     if (currentState != GameState::Playing) return; // State might change in collisions
     cleanupEntities();
@@ -628,12 +1477,10 @@ void Game::update(float dt) {
         if (currentLevelIndex < totalLevels) { nextLevel(); }
         else {
             currentState = GameState::Victory;
-            string scoreStr = player_ptr ? to_string(player_ptr->getScore()) : "N/A";
-            messageText.setString("YOU WIN!\nScore: " + scoreStr + "\nPress R");
+            messageText.setString(player_ptr ? frameArena.format("YOU WIN!\nScore: %d\nPress R", player_ptr->getScore()) : "YOU WIN!\nScore: N/A\nPress R");
             if (player_ptr && player_ptr->isActive()) player_ptr->destroy();
         }
     }
-    if (currentState == GameState::Playing || currentState == GameState::Paused) { updateUI(); }
 }
 
 void Game::checkCollisions() {
@@ -649,9 +1496,14 @@ void Game::checkCollisions() {
     for (auto& bullet_ptr : bullets) {
         if (!bullet_ptr->isActive()) continue;
         Vector2i bPos = bullet_ptr->getPosition();
+        if (bullet_ptr->isHostile()) {
+            if (bPos == pPos) { setGameOver("Shot by an enemy!"); return; }
+            continue;
+        }
         for (auto& enemy : enemies) {
             if (enemy.isActive() && enemy.getPosition() == bPos) {
                 cout << "Hit! Enemy destroyed." << endl;
+                spawnEffect(enemy.getPosition(), Color(255, 140, 0), 60);
                 enemy.destroy();
                 bullet_ptr->destroy();
                 if (player_ptr) player_ptr->addScore(50);
@@ -663,40 +1515,67 @@ void Game::checkCollisions() {
 }
 
 void Game::cleanupEntities() {
-    bullets.erase(remove_if(bullets.begin(), bullets.end(), [](const unique_ptr<Bullet>& b) { return !b->isActive(); }), bullets.end());
+    recycleBullets(false);
     enemies.erase(remove_if(enemies.begin(), enemies.end(), [](const Enemy& e) { return !e.isActive(); }), enemies.end());
 }
 
+// Moves spent (or, with all=true, every) bullet back into the pool.
+void Game::recycleBullets(bool all) {
+    for (auto& bullet_ptr : bullets) {
+        if (all || !bullet_ptr->isActive()) bulletPool.push_back(move(bullet_ptr));
+    }
+    bullets.erase(remove(bullets.begin(), bullets.end(), nullptr), bullets.end());
+}
+
 void Game::render() {
+    if (currentState == GameState::Playing || currentState == GameState::Paused) { updateUI(); }
     window.clear(Color(20, 20, 20));
     currentLevelData.draw(window, CELL_SIZE);
     for (const auto& enemy : enemies) { if (enemy.isActive()) enemy.draw(window, CELL_SIZE); }
     for (const auto& bullet_ptr : bullets) { if (bullet_ptr->isActive()) bullet_ptr->draw(window, CELL_SIZE); }
     if (player_ptr && player_ptr->isActive()) { player_ptr->draw(window, CELL_SIZE); }
+    particles.draw(window);
     window.draw(scoreText);
     window.draw(levelText);
     if (currentState != GameState::Playing && currentState != GameState::LevelComplete) {
-        RectangleShape overlay(Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT));
-        overlay.setFillColor(Color(0, 0, 0, 180));
-        window.draw(overlay);
+        window.draw(overlayShape);
         FloatRect textRect = messageText.getLocalBounds();
         messageText.setOrigin(textRect.left + textRect.width / 2.0f, textRect.top + textRect.height / 2.0f);
         messageText.setPosition(WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f);
         window.draw(messageText);
     }
+    if (showStats) {
+        updateStatsOverlay();
+        window.draw(statsText);
+    }
     window.display();
+    recordDisplayLatency();
+}
+
+// Decodes one level from the campaign pack, or reads levelN.txt when there is no pack.
+bool Game::readLevel(int levelNumber, Level& out) {
+    if (campaign.isOpen()) { return campaign.decodeLevel(levelNumber, out); }
+    return out.loadFromFile("level" + to_string(levelNumber) + ".txt");
 }
 
 void Game::loadLevel(int levelNumber) {
     cout << "Loading level " << levelNumber << "..." << endl;
-    string filename = "level" + to_string(levelNumber) + ".txt";
-    if (!currentLevelData.loadFromFile(filename)) {
-        cerr << "Error loading " << filename << endl;
+    if (!readLevel(levelNumber, currentLevelData)) {
+        cerr << "Error loading level " << levelNumber << endl;
         if (levelNumber != 1) { cout << "Falling back to level 1." << endl; loadLevel(1); }
-        else { setGameOver("FATAL: Cannot load level1.txt!"); }
+        else { setGameOver("FATAL: Cannot load level 1!"); }
         return;
     }
     currentLevelIndex = levelNumber;
+    currentLevelInfo = campaign.isOpen() ? campaign.getLevelInfo(levelNumber) : LevelInfo();
+    levelFileSnapshot = currentLevelData;
+    currentLevelFile = "level" + to_string(levelNumber) + ".txt";
+    if (campaign.isOpen()) {
+        // Edits go to the level's source file; only watch the pack itself when no source ships with it
+        currentLevelFile = campaign.getSourcePath(levelNumber);
+        if (!ifstream(currentLevelFile)) { currentLevelFile = campaign.getPath(); }
+    }
+    levelWatcher.watch(currentLevelFile);
     if (player_ptr) {
         setupLevel();
         currentState = GameState::Playing; timeScale = 1.0f; messageText.setString("");
@@ -706,9 +1585,69 @@ void Game::loadLevel(int levelNumber) {
     }
 }
 
+// Applies on-disk edits to the live level without restarting it. The diff is
+// taken against the level as last loaded, so items already collected this
+// session stay collected unless their cell was edited. With a campaign pack
+// the level's source file is watched when it sits next to the pack; only a
+// pack shipped without sources is re-indexed and the current level decoded again.
+// Live entities follow the edit: a removed (or retyped) X/R marker despawns the
+// enemy it spawned, wherever that enemy has walked to, and a new marker spawns
+// one unless an enemy already stands there. A wall written over the player or
+// a live enemy rejects the whole edit; bullets inside new walls are dropped.
+void Game::checkLevelReload() {
+    if (!levelWatcher.poll()) return;
+    Level fresh;
+    if (campaign.isOpen() && currentLevelFile == campaign.getPath()) {
+        // Parse into a separate pack so a bad save leaves the live pack and its index untouched
+        CampaignPack reloaded;
+        if (!reloaded.open(campaign.getPath()) || !reloaded.decodeLevel(currentLevelIndex, fresh)) {
+            cerr << "Hot-reload: keeping the loaded pack, '" << currentLevelFile << "' has no usable level " << currentLevelIndex << endl;
+            return;
+        }
+        campaign = move(reloaded); // Adopt the new index even if the grid diff below is rejected
+        totalLevels = campaign.getLevelCount();
+        currentLevelInfo = campaign.getLevelInfo(currentLevelIndex);
+    }
+    else if (!fresh.loadFromFile(currentLevelFile)) {
+        cerr << "Hot-reload: keeping current level, '" << currentLevelFile << "' failed to parse." << endl;
+        return;
+    }
+    vector<Vector2i> changed;
+    if (!levelFileSnapshot.diffCells(fresh, changed)) {
+        cerr << "Hot-reload: '" << currentLevelFile << "' changed size, restart the level to apply it." << endl;
+        return;
+    }
+    for (const auto& cell : changed) {
+        if (!fresh.isWall(cell.x, cell.y)) continue;
+        bool buried = player_ptr && player_ptr->isActive() && player_ptr->getPosition() == cell;
+        buried = buried || any_of(enemies.begin(), enemies.end(), [&](const Enemy& e) { return e.isActive() && e.getPosition() == cell; });
+        if (buried) {
+            cerr << "Hot-reload: '" << currentLevelFile << "' puts a wall on an occupied cell (" << cell.x << "," << cell.y << "), not applied." << endl;
+            return; // Snapshot unchanged, so the next save is diffed in full again
+        }
+    }
+    for (const auto& cell : changed) {
+        char oldType = currentLevelData.getCell(cell.x, cell.y);
+        char type = fresh.getCell(cell.x, cell.y);
+        currentLevelData.setCell(cell.x, cell.y, type);
+        if ((oldType == ENEMY_CHAR || oldType == RANGED_ENEMY_CHAR) && type != oldType) {
+            for (auto& enemy : enemies) { if (enemy.isActive() && enemy.getSpawnCell() == cell) enemy.destroy(); }
+        }
+        if (type == WALL_CHAR) {
+            for (auto& bullet_ptr : bullets) { if (bullet_ptr->isActive() && bullet_ptr->getPosition() == cell) bullet_ptr->destroy(); }
+        }
+        if ((type == ENEMY_CHAR || type == RANGED_ENEMY_CHAR) && type != oldType) {
+            bool occupied = any_of(enemies.begin(), enemies.end(), [&](const Enemy& e) { return e.isActive() && e.getPosition() == cell; });
+            if (!occupied) enemies.emplace_back(cell.x, cell.y, enemyTexture, type == RANGED_ENEMY_CHAR);
+        }
+    }
+    levelFileSnapshot = fresh;
+    cout << "Hot-reload: applied " << changed.size() << " changed cell(s) from '" << currentLevelFile << "'" << endl;
+}
+
 void Game::setupLevel() {
     cout << "Setting up level " << currentLevelIndex << "..." << endl;
-    bullets.clear(); enemies.clear();
+    recycleBullets(true); enemies.clear(); // Particles carry over so the last kill's burst still shows
     if (!player_ptr) { currentState = GameState::GameOver; messageText.setString("FATAL:\nPlayer setup fail."); return; }
     Vector2i playerStart = currentLevelData.findChar(PLAYER_CHAR);
     if (playerStart.x == -1) {
@@ -728,8 +1667,9 @@ void Game::setupLevel() {
     player_ptr->setPosition(playerStart.x, playerStart.y);
     for (size_t y = 0; y < currentLevelData.getHeight(); ++y) {
         for (size_t x = 0; x < currentLevelData.getWidth(); ++x) {
-            if (currentLevelData.getCell(static_cast<int>(x), static_cast<int>(y)) == ENEMY_CHAR) {
-                enemies.emplace_back(static_cast<int>(x), static_cast<int>(y), enemyTexture);
+            char cell = currentLevelData.getCell(static_cast<int>(x), static_cast<int>(y));
+            if (cell == ENEMY_CHAR || cell == RANGED_ENEMY_CHAR) {
+                enemies.emplace_back(static_cast<int>(x), static_cast<int>(y), enemyTexture, cell == RANGED_ENEMY_CHAR);
             }
         }
     }
@@ -745,8 +1685,7 @@ void Game::nextLevel() {
     else {
         if (currentState != GameState::Victory) { // Prevent multiple calls
             currentState = GameState::Victory;
-            string scoreStr = player_ptr ? to_string(player_ptr->getScore()) : "N/A";
-            messageText.setString("YOU WIN!\nScore: " + scoreStr + "\nPress R");
+            messageText.setString(player_ptr ? frameArena.format("YOU WIN!\nScore: %d\nPress R", player_ptr->getScore()) : "YOU WIN!\nScore: N/A\nPress R");
             if (player_ptr && player_ptr->isActive()) player_ptr->destroy();
         }
     }
@@ -755,6 +1694,7 @@ void Game::nextLevel() {
 void Game::resetGame() {
     cout << "Resetting game..." << endl;
     currentState = GameState::Playing; timeScale = 1.0f; currentLevelIndex = 1; messageText.setString("");
+    particles.clear();
     loadLevel(currentLevelIndex); // This handles setup
 }
 
@@ -764,31 +1704,584 @@ void Game::setupUI() {
     scoreText.setFont(font); scoreText.setCharacterSize(24); scoreText.setFillColor(Color::White); scoreText.setPosition(20.f, uiY);
     levelText.setFont(font); levelText.setCharacterSize(24); levelText.setFillColor(Color::White); levelText.setPosition(WINDOW_WIDTH - 150.f, uiY);
     messageText.setFont(font); messageText.setCharacterSize(40); messageText.setFillColor(Color::Yellow); messageText.setStyle(Text::Bold);
+    statsText.setFont(font); statsText.setCharacterSize(14); statsText.setFillColor(Color::Green); statsText.setPosition(5.f, 5.f);
+    overlayShape.setSize(Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT)); overlayShape.setFillColor(Color(0, 0, 0, 180));
+    // Grow the strings updateUI rewrites once, so later refreshes fit in place
+    uiString = String(string(UI_TEXT_RESERVE, ' '));
+    scoreText.setString(uiString);
+    levelText.setString(uiString);
 }
 
+// Only touches the texts when the values change, and then without a
+// temporary sf::String, so score changes in play stay off the heap.
 void Game::updateUI() {
-    scoreText.setString("Score: " + (player_ptr ? to_string(player_ptr->getScore()) : "N/A"));
-    levelText.setString("Level: " + to_string(currentLevelIndex));
+    int score = player_ptr ? player_ptr->getScore() : INT_MIN;
+    if (score != shownScore) {
+        shownScore = score;
+        setUiText(scoreText, player_ptr ? frameArena.format("Score: %d", score) : "Score: N/A");
+    }
+    if (currentLevelIndex != shownLevel) {
+        shownLevel = currentLevelIndex;
+        setUiText(levelText, frameArena.format("Level: %d", currentLevelIndex));
+    }
+}
+
+// Text::setString(const char*) would build a heap-backed sf::String per call.
+// Appending single characters (small enough for the short-string buffer) to
+// uiString and copying it into the Text reuses capacity reserved in setupUI.
+void Game::setUiText(Text& text, const char* value) {
+    uiString.clear();
+    for (const char* c = value; *c; ++c) { uiString += String(static_cast<Uint32>(static_cast<unsigned char>(*c))); }
+    text.setString(uiString);
+}
+
+void Game::updateStatsOverlay() {
+    unsigned long long before = heapAllocationCount.load(memory_order_relaxed);
+    statsText.setString(frameArena.format("Heap allocs/frame: %llu\nFrame arena: %zu / %zu B (peak %zu)\nInput latency: p50 %.1f ms, p99 %.1f ms\nParticles: %zu / %zu, update %.0f us",
+        lastFrameAllocations, frameArena.getUsed(), frameArena.getCapacity(), frameArena.getPeak(),
+        inputLatency.percentile(0.5f), inputLatency.percentile(0.99f),
+        particles.getLiveCount(), particles.getCapacity(), particles.getLastUpdateMicroseconds()));
+    statsAllocations += heapAllocationCount.load(memory_order_relaxed) - before;
+}
+
+bool Game::getPlayerPosition(Vector2i& out) const {
+    if (!player_ptr || !player_ptr->isActive()) return false;
+    out = player_ptr->getPosition();
+    return true;
+}
+
+void Game::spawnBullet(Vector2i start, Vector2i direction, bool hostile) {
+    if (bulletPool.empty()) {
+        bullets.push_back(make_unique<Bullet>(start.x, start.y, direction.x, direction.y, hostile));
+        return;
+    }
+    bullets.push_back(move(bulletPool.back()));
+    bulletPool.pop_back();
+    bullets.back()->reset(start.x, start.y, direction.x, direction.y, hostile);
+}
+
+void Game::spawnEnemyBullet(Vector2i from, Vector2i direction) {
+    int startX = from.x + direction.x, startY = from.y + direction.y;
+    if (currentLevelData.isWall(startX, startY)) return;
+    spawnBullet(Vector2i(startX, startY), direction, true);
+}
+
+void Game::spawnEffect(Vector2i cell, Color color, int count) {
+    Vector2f center(cell.x * CELL_SIZE + CELL_SIZE / 2.f, cell.y * CELL_SIZE + CELL_SIZE / 2.f);
+    particles.emitBurst(center, color, count, CELL_SIZE * 3.f, 0.8f);
+}
+
+const LevelInfo& Game::getLevelInfo() const { return currentLevelInfo; }
+
+// Drives the real tick (input queue, entities, bullets, collisions, particles)
+// without a window. Ticks that end the game or change level are transitions,
+// not steady state, so their allocations are left out. Text refreshes live in
+// render(), where SFML's Text::setString allocates whenever a value changes.
+// Plays with a simple bot: step toward an enemy in clear line of sight and
+// shoot it, otherwise head for the first enemy (with some random steps). Each measured tick includes the score/level
+// text refresh; scoreChanges counts the measured ticks that rewrote the score.
+unsigned long long Game::measureSteadyStateAllocations(float warmupSeconds, float measureSeconds, size_t& steadyTicks, size_t& scoreChanges) {
+    const float dt = 1.f / 60.f;
+    const Keyboard::Key moves[4] = { Keyboard::W, Keyboard::S, Keyboard::A, Keyboard::D };
+    const Vector2i steps[4] = { Vector2i(0, -1), Vector2i(0, 1), Vector2i(-1, 0), Vector2i(1, 0) };
+    uint32_t rng = 2463534242u;
+    unsigned long long allocations = 0;
+    steadyTicks = 0;
+    scoreChanges = 0;
+    Clock wallClock; // Shot and enemy timers run on sf::Clock, so the check runs in real time too
+    Clock aimClock;
+    while (wallClock.getElapsedTime().asSeconds() < warmupSeconds + measureSeconds) {
+        if (currentState != GameState::Playing || !player_ptr || !player_ptr->isActive()) { resetGame(); continue; }
+        const Vector2i pos = player_ptr->getPosition();
+        bool aimed = false;
+        if (aimClock.getElapsedTime().asSeconds() >= getLevelInfo().shootCooldown) {
+            for (const auto& enemy : enemies) {
+                const Vector2i e = enemy.getPosition();
+                if (!enemy.isActive() || abs(e.x - pos.x) + abs(e.y - pos.y) < 2) continue;
+                if (!currentLevelData.hasLineOfSight(pos.x, pos.y, e.x, e.y)) continue;
+                const int d = e.y < pos.y ? 0 : e.y > pos.y ? 1 : e.x < pos.x ? 2 : 3;
+                queueInput(moves[d]); // Stepping toward it is the only way to face it
+                queueInput(Keyboard::Space);
+                aimClock.restart();
+                aimed = true;
+                break;
+            }
+        }
+        rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+        if (!aimed && !enemies.empty() && rng % 12 == 1) { // A few steps a second, never into a wall or an enemy
+            const Vector2i target = enemies.front().getPosition();
+            const int dx = target.x - pos.x, dy = target.y - pos.y;
+            int d = static_cast<int>((rng >> 8) % 4);
+            if ((rng >> 16) % 3 != 0) { d = abs(dy) >= abs(dx) ? (dy < 0 ? 0 : 1) : (dx < 0 ? 2 : 3); }
+            const Vector2i next(pos.x + steps[d].x, pos.y + steps[d].y);
+            bool occupied = currentLevelData.isWall(next.x, next.y);
+            for (const auto& enemy : enemies) { occupied = occupied || enemy.getPosition() == next; }
+            if (!occupied) queueInput(moves[d]);
+        }
+        const int levelBefore = currentLevelIndex;
+        const int scoreBefore = shownScore;
+        const unsigned long long before = heapAllocationCount.load(memory_order_relaxed);
+        update(dt);
+        particles.update(dt);
+        if (currentState == GameState::Playing) updateUI(); // The text refresh render() does; drawing itself needs a window
+        frameArena.reset();
+        const unsigned long long spent = heapAllocationCount.load(memory_order_relaxed) - before;
+        sleep(seconds(dt)); // Pace ticks like the real loop so moves, shots and enemy steps interleave normally
+        if (currentState != GameState::Playing || currentLevelIndex != levelBefore) continue;
+        if (wallClock.getElapsedTime().asSeconds() < warmupSeconds) continue;
+        allocations += spent;
+        ++steadyTicks;
+        if (shownScore != scoreBefore) ++scoreChanges;
+    }
+    return allocations;
 }
 
 // Must be defined AFTER Game class definition
-void Game::setGameOver(const string& message) {
+void Game::setGameOver(const char* message) {
     if (currentState == GameState::Playing) {
         cout << "GAME OVER: " << message << endl;
         currentState = GameState::GameOver;
         timeScale = 0.0f;
-        messageText.setString("GAME OVER!\n" + message + "\nPress R to Restart");
-        if (player_ptr && player_ptr->isActive()) { player_ptr->destroy(); }
+        messageText.setString(frameArena.format("GAME OVER!\n%s\nPress R to Restart", message));
+        if (player_ptr) {
+            // Player::tryMove destroys the player before calling here, so don't gate the burst on isActive()
+            spawnEffect(player_ptr->getPosition(), Color::Red, 200);
+            if (player_ptr->isActive()) player_ptr->destroy();
+        }
     }
     else {
         cout << "setGameOver called when not playing. State: " << static_cast<int>(currentState) << endl;
     }
 }
 
+// ==========================================================================
+// Vectorized Environment Implementation
+// ==========================================================================
+Keyboard::Key envActionToKey(int action) {
+    switch (static_cast<EnvAction>(action)) {
+    case EnvAction::Up:    return Keyboard::W;
+    case EnvAction::Down:  return Keyboard::S;
+    case EnvAction::Left:  return Keyboard::A;
+    case EnvAction::Right: return Keyboard::D;
+    case EnvAction::Shoot: return Keyboard::Space;
+    default:               return Keyboard::Unknown;
+    }
+}
+
+EnvInstance::EnvInstance()
+    : tuning(nullptr), player(0, 0), facing(0, -1), alive(false), score(0), steps(0),
+      shootTimer(0.f), enemyTimer(0.f), bulletTimer(0.f), rngState(1) {}
+
+void EnvInstance::reset(const Level& templateLevel, const LevelInfo& levelInfo, uint32_t seed) {
+    level = templateLevel; // Restores collected items; row strings keep their capacity
+    tuning = &levelInfo;
+    rngState = seed ? seed : 1u;
+    alive = true; score = 0; steps = 0;
+    shootTimer = 0.f; enemyTimer = 0.f; bulletTimer = 0.f;
+    facing = { 0, -1 };
+    player = level.findChar(PLAYER_CHAR);
+    if (player.x == -1) { // Same fallback as Game::setupLevel: first non-wall cell
+        for (size_t y = 0; y < level.getHeight() && player.x == -1; ++y)
+            for (size_t x = 0; x < level.getWidth() && player.x == -1; ++x)
+                if (!level.isWall(static_cast<int>(x), static_cast<int>(y)))
+                    player = { static_cast<int>(x), static_cast<int>(y) };
+        if (player.x == -1) player = { 0, 0 };
+    }
+    enemies.clear();
+    bullets.clear();
+    for (size_t y = 0; y < level.getHeight(); ++y) {
+        for (size_t x = 0; x < level.getWidth(); ++x) {
+            char cell = level.getCell(static_cast<int>(x), static_cast<int>(y));
+            if (cell == ENEMY_CHAR || cell == RANGED_ENEMY_CHAR)
+                enemies.push_back({ Vector2i(static_cast<int>(x), static_cast<int>(y)), cell == RANGED_ENEMY_CHAR, 0.f });
+        }
+    }
+}
+
+uint32_t EnvInstance::nextRandom() {
+    // xorshift32: per-instance state so worker threads never share rand()
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+void EnvInstance::step(Keyboard::Key key, float& reward, bool& done) {
+    int scoreBefore = score;
+    shootTimer += ENV_STEP_DT;
+    applyKey(key);
+    if (alive) {
+        enemiesShoot(); // Enemy::update shoots before it moves
+        enemyTimer += ENV_STEP_DT;
+        if (enemyTimer >= tuning->enemyMoveInterval) { moveEnemies(); enemyTimer = 0.f; }
+        checkCollisions(); // A point-blank shot starts on its target's cell; Game hits it before the bullet steps
+        if (alive) {
+            moveBullets();
+            checkCollisions();
+        }
+        bullets.erase(remove_if(bullets.begin(), bullets.end(), [](const EnvBullet& b) { return !b.active; }), bullets.end());
+    }
+    ++steps;
+    reward = static_cast<float>(score - scoreBefore);
+    done = !alive || enemies.empty() || steps >= ENV_MAX_STEPS;
+}
+
+// Same rules as Player::handleInput / Player::tryMove / Player::shoot.
+void EnvInstance::applyKey(Keyboard::Key key) {
+    int dx = 0, dy = 0;
+    switch (key) {
+    case Keyboard::W: dy = -1; break;
+    case Keyboard::S: dy = 1;  break;
+    case Keyboard::A: dx = -1; break;
+    case Keyboard::D: dx = 1;  break;
+    case Keyboard::Space:
+        if (shootTimer >= tuning->shootCooldown) {
+            int bx = player.x + facing.x, by = player.y + facing.y;
+            if (!level.isWall(bx, by)) { bullets.push_back({ Vector2i(bx, by), facing, true, false }); }
+            shootTimer = 0.f;
+        }
+        return;
+    default: return;
+    }
+    facing = { dx, dy };
+    int nextX = player.x + dx, nextY = player.y + dy;
+    if (level.isWall(nextX, nextY)) { alive = false; return; } // Also covers out-of-bounds
+    player = { nextX, nextY };
+    if (level.isItem(nextX, nextY)) {
+        score += 10;
+        level.setCell(nextX, nextY, PATH_CHAR);
+    }
+}
+
+void EnvInstance::moveEnemies() {
+    for (auto& enemy : enemies) {
+        int dx = 0, dy = 0;
+        switch (nextRandom() % 5) {
+        case 0: dy = -1; break; case 1: dy = 1; break;
+        case 2: dx = -1; break; case 3: dx = 1; break;
+        default: continue;
+        }
+        int nextX = enemy.pos.x + dx, nextY = enemy.pos.y + dy;
+        if (!level.isWall(nextX, nextY) && !level.isItem(nextX, nextY)) { enemy.pos = { nextX, nextY }; }
+    }
+}
+
+// Same rule and timing as Enemy::tryShoot (cooldown from the level tuning).
+// A shot from an adjacent enemy spawns on the player's cell and is caught by
+// the collision check step() runs before moveBullets().
+void EnvInstance::enemiesShoot() {
+    for (auto& enemy : enemies) {
+        if (!enemy.ranged) continue;
+        enemy.shootTimer += ENV_STEP_DT;
+        if (enemy.shootTimer < tuning->enemyShootCooldown || enemy.pos == player) continue;
+        if (!level.hasLineOfSight(enemy.pos.x, enemy.pos.y, player.x, player.y)) continue;
+        Vector2i direction((player.x > enemy.pos.x) - (player.x < enemy.pos.x), (player.y > enemy.pos.y) - (player.y < enemy.pos.y));
+        Vector2i start(enemy.pos.x + direction.x, enemy.pos.y + direction.y);
+        if (!level.isWall(start.x, start.y)) { bullets.push_back({ start, direction, true, true }); }
+        enemy.shootTimer = 0.f;
+    }
+}
+
+void EnvInstance::moveBullets() {
+    bulletTimer += ENV_STEP_DT;
+    while (bulletTimer >= BULLET_TIME_PER_STEP) {
+        bulletTimer -= BULLET_TIME_PER_STEP;
+        for (auto& bullet : bullets) {
+            if (!bullet.active) continue;
+            Vector2i next(bullet.pos.x + bullet.vel.x, bullet.pos.y + bullet.vel.y);
+            if (level.isWall(next.x, next.y)) { bullet.active = false; continue; }
+            bullet.pos = next;
+        }
+    }
+}
+
+void EnvInstance::checkCollisions() {
+    for (const auto& enemy : enemies) {
+        if (enemy.pos == player) { alive = false; return; }
+    }
+    for (auto& bullet : bullets) {
+        if (!bullet.active) continue;
+        if (bullet.hostile) {
+            if (bullet.pos == player) { alive = false; return; }
+            continue;
+        }
+        auto hit = find_if(enemies.begin(), enemies.end(), [&](const EnvEnemy& e) { return e.pos == bullet.pos; });
+        if (hit != enemies.end()) {
+            enemies.erase(hit);
+            bullet.active = false;
+            score += 50;
+        }
+    }
+}
+
+void EnvInstance::writeObservation(uint8_t* out) const {
+    const size_t width = level.getWidth(), height = level.getHeight();
+    const size_t planeSize = width * height;
+    memset(out, 0, OBS_PLANES * planeSize);
+    uint8_t* wallPlane = out;
+    uint8_t* itemPlane = out + planeSize;
+    uint8_t* enemyPlane = out + 2 * planeSize;
+    uint8_t* bulletPlane = out + 3 * planeSize;
+    uint8_t* playerPlane = out + 4 * planeSize;
+    for (size_t y = 0; y < height; ++y) {
+        for (size_t x = 0; x < width; ++x) {
+            char cell = level.getCell(static_cast<int>(x), static_cast<int>(y));
+            wallPlane[y * width + x] = (cell == WALL_CHAR);
+            itemPlane[y * width + x] = (cell == ITEM_CHAR);
+        }
+    }
+    for (const auto& enemy : enemies) { enemyPlane[enemy.pos.y * width + enemy.pos.x] = 1; }
+    for (const auto& bullet : bullets) {
+        if (bullet.active && level.isValid(bullet.pos.x, bullet.pos.y)) bulletPlane[bullet.pos.y * width + bullet.pos.x] = 1;
+    }
+    if (alive && level.isValid(player.x, player.y)) { playerPlane[player.y * width + player.x] = 1; }
+}
+
+VecEnv::VecEnv(size_t numEnvs, const string& levelSource, unsigned int threadCount)
+    : envs(numEnvs), numThreads(1), ready(false), jobSeed(0), jobActions(nullptr),
+      jobObservations(nullptr), jobRewards(nullptr), jobDones(nullptr),
+      currentJob(Job::None), jobGeneration(0), workersFinished(0) {
+    if (numEnvs == 0 || !loadTemplate(levelSource)) {
+        cerr << "VecEnv: could not initialise from '" << levelSource << "'" << endl;
+        return;
+    }
+    numThreads = threadCount ? threadCount : max(1u, thread::hardware_concurrency());
+    numThreads = static_cast<unsigned int>(min<size_t>(numThreads, numEnvs));
+    for (unsigned int i = 1; i < numThreads; ++i) { // Calling thread acts as worker 0
+        workers.emplace_back(&VecEnv::workerLoop, this, i);
+    }
+    ready = true;
+}
+
+bool VecEnv::loadTemplate(const string& levelSource) {
+    size_t hash = levelSource.find_last_of('#');
+    if (hash == string::npos) {
+        templateInfo = LevelInfo();
+        return templateLevel.loadFromFile(levelSource);
+    }
+    CampaignPack pack;
+    int levelNumber = atoi(levelSource.c_str() + hash + 1);
+    if (!pack.open(levelSource.substr(0, hash)) || !pack.decodeLevel(levelNumber, templateLevel)) return false;
+    templateInfo = pack.getLevelInfo(levelNumber);
+    return true;
+}
+
+VecEnv::~VecEnv() {
+    {
+        lock_guard<mutex> lock(poolMutex);
+        currentJob = Job::Quit;
+        ++jobGeneration;
+    }
+    jobReady.notify_all();
+    for (auto& worker : workers) { worker.join(); }
+}
+
+bool VecEnv::isReady() const { return ready; }
+size_t VecEnv::getNumEnvs() const { return envs.size(); }
+size_t VecEnv::getObservationSize() const { return OBS_PLANES * templateLevel.getWidth() * templateLevel.getHeight(); }
+
+void VecEnv::reset(uint32_t seed, uint8_t* observations) {
+    if (!ready) return;
+    jobSeed = seed;
+    jobObservations = observations;
+    dispatch(Job::Reset);
+}
+
+void VecEnv::step(const int* actions, uint8_t* observations, float* rewards, uint8_t* dones) {
+    if (!ready) return;
+    jobActions = actions;
+    jobObservations = observations;
+    jobRewards = rewards;
+    jobDones = dones;
+    dispatch(Job::Step);
+}
+
+void VecEnv::dispatch(Job job) {
+    {
+        lock_guard<mutex> lock(poolMutex);
+        currentJob = job;
+        workersFinished = 0;
+        ++jobGeneration;
+    }
+    jobReady.notify_all();
+    runRange(0);
+    unique_lock<mutex> lock(poolMutex);
+    jobDone.wait(lock, [this] { return workersFinished == workers.size(); });
+}
+
+void VecEnv::workerLoop(unsigned int workerIndex) {
+    unsigned long long seenGeneration = 0;
+    while (true) {
+        {
+            unique_lock<mutex> lock(poolMutex);
+            jobReady.wait(lock, [&] { return jobGeneration != seenGeneration; });
+            seenGeneration = jobGeneration;
+            if (currentJob == Job::Quit) return;
+        }
+        runRange(workerIndex);
+        {
+            lock_guard<mutex> lock(poolMutex);
+            ++workersFinished;
+        }
+        jobDone.notify_one();
+    }
+}
+
+void VecEnv::runRange(unsigned int workerIndex) {
+    const size_t begin = envs.size() * workerIndex / numThreads;
+    const size_t end = envs.size() * (workerIndex + 1) / numThreads;
+    const size_t obsSize = getObservationSize();
+    for (size_t i = begin; i < end; ++i) {
+        uint8_t* obs = jobObservations + i * obsSize;
+        if (currentJob == Job::Reset) {
+            envs[i].reset(templateLevel, templateInfo, jobSeed ^ (static_cast<uint32_t>(i) * 0x9E3779B9u));
+        }
+        else {
+            float reward = 0.f;
+            bool done = false;
+            envs[i].step(envActionToKey(jobActions[i]), reward, done);
+            jobRewards[i] = reward;
+            jobDones[i] = done;
+            if (done) { envs[i].reset(templateLevel, templateInfo, envs[i].drawSeed()); }
+        }
+        envs[i].writeObservation(obs);
+    }
+}
+
+// Headless throughput check: Virat v Thanos.exe --bench-env [numEnvs] [steps] [level] [threads]
+int runEnvBenchmark(int argc, char* argv[]) {
+    size_t numEnvs = argc > 2 ? static_cast<size_t>(atoi(argv[2])) : 256;
+    int steps = argc > 3 ? atoi(argv[3]) : 2000;
+    string levelFile = argc > 4 ? argv[4] : "level1.txt";
+    unsigned int threads = argc > 5 ? static_cast<unsigned int>(atoi(argv[5])) : 0;
+    VecEnv env(numEnvs, levelFile, threads);
+    if (!env.isReady()) return EXIT_FAILURE;
+    vector<uint8_t> observations(numEnvs * env.getObservationSize());
+    vector<float> rewards(numEnvs);
+    vector<uint8_t> dones(numEnvs);
+    vector<int> actions(numEnvs);
+    env.reset(12345u, observations.data());
+    uint32_t rng = 2463534242u;
+    size_t episodes = 0;
+    auto start = chrono::steady_clock::now();
+    for (int s = 0; s < steps; ++s) {
+        for (auto& action : actions) {
+            rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+            action = static_cast<int>(rng % static_cast<uint32_t>(EnvAction::Count));
+        }
+        env.step(actions.data(), observations.data(), rewards.data(), dones.data());
+        for (uint8_t d : dones) episodes += d;
+    }
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    double envSteps = static_cast<double>(numEnvs) * steps;
+    cout << "VecEnv: " << numEnvs << " envs x " << steps << " steps in " << elapsed << "s = "
+         << static_cast<long long>(envSteps / elapsed) << " env-steps/s (" << episodes << " episodes finished)" << endl;
+    return EXIT_SUCCESS;
+}
+
+// Steady-state allocation check: Virat v Thanos.exe --alloc-check [level]
+// Runs real Game ticks headlessly on the normal campaign, then a warmed-up
+// VecEnv on [level], and fails if steady-state play in either touches the heap.
+int runAllocationCheck(int argc, char* argv[]) {
+    unsigned long long gameAllocations = 0;
+    size_t steadyTicks = 0, scoreChanges = 0;
+    {
+        Game game(true);
+        gameAllocations = game.measureSteadyStateAllocations(1.f, 4.f, steadyTicks, scoreChanges);
+    }
+    cout << "Allocation check (Game::update + updateUI): " << gameAllocations << " heap allocation(s) over " << steadyTicks
+         << " steady-state ticks (" << scoreChanges << " score refreshes)" << endl;
+    if (steadyTicks == 0 || scoreChanges == 0) { cerr << "Allocation check: no steady-state ticks with a score change were measured" << endl; return EXIT_FAILURE; }
+    const size_t numEnvs = 64;
+    const int warmupSteps = 500, measuredSteps = 5000;
+    VecEnv env(numEnvs, argc > 2 ? argv[2] : "level1.txt", 1);
+    if (!env.isReady()) return EXIT_FAILURE;
+    vector<uint8_t> observations(numEnvs * env.getObservationSize());
+    vector<float> rewards(numEnvs);
+    vector<uint8_t> dones(numEnvs);
+    vector<int> actions(numEnvs);
+    env.reset(1u, observations.data());
+    unsigned long long startAllocations = 0;
+    for (int s = 0; s < warmupSteps + measuredSteps; ++s) {
+        if (s == warmupSteps) startAllocations = heapAllocationCount.load();
+        for (size_t i = 0; i < numEnvs; ++i) actions[i] = static_cast<int>((s * 7 + i * 13) % static_cast<int>(EnvAction::Count));
+        env.step(actions.data(), observations.data(), rewards.data(), dones.data());
+    }
+    unsigned long long allocations = heapAllocationCount.load() - startAllocations;
+    cout << "Allocation check (VecEnv): " << allocations << " heap allocation(s) over " << measuredSteps << " steady-state steps" << endl;
+    return (gameAllocations == 0 && allocations == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Steps one EnvInstance on an inline level until it finishes or maxSteps runs out.
+static bool runEnvCase(const char* name, const char* layout, Keyboard::Key key, int maxSteps, bool expectAlive, float expectReward) {
+    Level level;
+    LevelInfo tuning;
+    tuning.enemyMoveInterval = 1000.f; // Keep enemies where the layout puts them
+    if (!level.loadFromMemory(layout, name)) return false;
+    EnvInstance env;
+    env.reset(level, tuning, 1u);
+    float totalReward = 0.f, reward = 0.f;
+    bool done = false;
+    int steps = 0;
+    while (!done && steps < maxSteps) {
+        env.step(key, reward, done);
+        totalReward += reward;
+        ++steps;
+    }
+    bool alive = env.isAlive();
+    bool passed = alive == expectAlive && totalReward == expectReward;
+    cout << (passed ? "  ok   " : "  FAIL ") << name << ": " << steps << " steps, reward " << totalReward
+         << (alive ? "" : ", player died") << endl;
+    return passed;
+}
+
+// Env rule check: Virat v Thanos.exe --check-env
+// Small fixed layouts where EnvInstance must reach the same outcome as Game.
+int runEnvRuleCheck(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= runEnvCase("point-blank shot", "#####\n# X #\n# P #\n#####\n", Keyboard::Space, 20, true, 50.f);
+    passed &= runEnvCase("adjacent ranged enemy", "#####\n#PR #\n#####\n", Keyboard::Unknown, 60, false, 0.f);
+    cout << "Env rule check: " << (passed ? "passed" : "FAILED") << endl;
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Particle throughput check: Virat v Thanos.exe --bench-particles [count] [frames]
+int runParticleBenchmark(int argc, char* argv[]) {
+    size_t count = argc > 2 ? static_cast<size_t>(atoi(argv[2])) : PARTICLE_CAPACITY;
+    int frames = argc > 3 ? atoi(argv[3]) : 600;
+    ParticleSystem system(count);
+    float totalMicroseconds = 0.f;
+    for (int f = 0; f < frames; ++f) {
+        // Top the pool back up each frame so the full count stays live
+        system.emitBurst(Vector2f(WINDOW_WIDTH / 2.f, WINDOW_HEIGHT / 2.f), Color::White,
+            static_cast<int>(count - system.getLiveCount()), CELL_SIZE * 3.f, 10.f);
+        system.update(1.f / 60.f);
+        totalMicroseconds += system.getLastUpdateMicroseconds();
+    }
+    cout << "Particles: " << system.getLiveCount() << " live, average update " << totalMicroseconds / frames
+         << " us over " << frames << " frames (60 fps budget: 16667 us)" << endl;
+    return EXIT_SUCCESS;
+}
+
+// Pack loose levels: Virat v Thanos.exe --build-pack campaign.pak level1.txt level2.txt ...
+int runPackBuilder(int argc, char* argv[]) {
+    if (argc < 4) {
+        cerr << "Usage: --build-pack <output.pak> <level.txt>..." << endl;
+        return EXIT_FAILURE;
+    }
+    vector<string> levelFiles(argv + 3, argv + argc);
+    return CampaignPack::build(argv[2], levelFiles) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 // ==========================================================================
 // Main Function
 // ==========================================================================
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--bench-env") { return runEnvBenchmark(argc, argv); }
+    if (argc > 1 && string(argv[1]) == "--alloc-check") { return runAllocationCheck(argc, argv); }
+    if (argc > 1 && string(argv[1]) == "--check-env") { return runEnvRuleCheck(argc, argv); }
+    if (argc > 1 && string(argv[1]) == "--bench-particles") { return runParticleBenchmark(argc, argv); }
+    if (argc > 1 && string(argv[1]) == "--build-pack") { return runPackBuilder(argc, argv); }
     cout << "Application Start..." << endl;
     try {
         Game game;